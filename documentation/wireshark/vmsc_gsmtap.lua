@@ -0,0 +1,19 @@
+-- vMSC: разбор зеркала --gsmtap в Wireshark.
+--
+-- DTAP A-интерфейса vMSC шлёт как GSMTAP ABIS — его Wireshark понимает сам.
+-- Остальные кадры (BSSMAP, MAP, ISUP, M3UA-управление) идут целым M3UA PDU
+-- с частным типом GSMTAP 0xFE (GSMTAP_TYPE_VMSC_M3UA в main.cpp), который
+-- штатный диссектор GSMTAP не знает. Этот скрипт отдаёт тип 0xFE диссектору m3ua.
+--
+-- Подключение:
+--   wireshark -X lua_script:documentation/wireshark/vmsc_gsmtap.lua
+--   tshark    -X lua_script:documentation/wireshark/vmsc_gsmtap.lua -i lo -f "udp port 4729"
+-- или скопировать файл в каталог личных плагинов (Help → About → Folders).
+
+local GSMTAP_TYPE_VMSC_M3UA = 0xFE
+
+local m3ua = Dissector.get("m3ua")
+local gsmtap_type = DissectorTable.get("gsmtap.type")
+if m3ua and gsmtap_type then
+    gsmtap_type:add(GSMTAP_TYPE_VMSC_M3UA, m3ua)
+end
@@ -0,0 +1,74 @@
+#!/bin/bash
+# Импорт абонентов (--import-subscribers): CSV и двоичный VMSCSUB1.
+#   1. CSV с заголовком: строки с ошибками и повторы IMSI пропущены;
+#   2. --export-subscribers → VMSCSUB1 → повторный экспорт даёт тот же файл;
+#   3. --subscriber находит загруженного по IMSI, MSISDN и метке;
+#   4. --each-subscriber: итерации идут по загруженным абонентам (IMSI, MSISDN, TMSI),
+#      с --threads — каждый абонент один раз за проход.
+# Запуск: tests/subscriber_import.sh /abs/path/to/vmsc   (ctest: subscriber_import)
+
+BIN=$(realpath "${1:-./build/vmsc}")
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+cd "$DIR" || exit 1
+# C- и A-interface на loopback: --send-udp уходит в пустой порт
+for s in C-interface A-interface; do
+    printf '[%s]\nlocal_ip=127.0.0.1\nlocal_port=0\nremote_ip=127.0.0.1\nremote_port=9\n' "$s"
+done > vmsc.conf
+
+PASS=0
+FAIL=0
+check() {
+    if eval "$2"; then echo "✓ $1"; PASS=$((PASS + 1)); else echo "✗ $1"; FAIL=$((FAIL + 1)); fi
+}
+
+# ── 1. CSV ────────────────────────────────────────────────────────────────
+{
+    echo "# тестовая популяция"
+    echo "imsi,msisdn,tmsi,ki,label"
+    for i in $(seq 1 5000); do
+        printf '25099%010d,7900%07d,0x%08X,000102030405060708090A0B0C0D0E0F,UE-%d\n' "$i" "$i" "$i" "$i"
+    done
+    echo "250990000000007,79999999999,,,повтор"
+    echo "2509900000x0008,,,,ошибка"
+    echo "250990000005001,,,0011,короткий Ki"
+} > subs.csv
+"$BIN" --no-color --no-lu --no-paging --import-subscribers subs.csv --export-subscribers a.bin > out 2> err
+check "CSV: 5000 абонентов" 'grep -q "Абоненты: 5000 из subs.csv" out'
+check "CSV: строки с ошибками (первая — 5004)" 'grep -q "ошибками 2 (первая — строка 5004)" err'
+check "CSV: повтор IMSI" 'grep -q "повторов IMSI 1" err'
+
+# ── 2. VMSCSUB1 ───────────────────────────────────────────────────────────
+check "bin: 24 + 5000 × 64 байт" '[ "$(stat -c %s a.bin)" = 320024 ]'
+"$BIN" --no-color --no-lu --no-paging --import-subscribers a.bin --export-subscribers b.bin > out 2>&1
+check "bin: 5000 абонентов" 'grep -q "Абоненты: 5000 из a.bin (VMSCSUB1" out'
+check "bin: повторный экспорт совпадает" 'cmp -s a.bin b.bin'
+
+# ── 3. --subscriber ───────────────────────────────────────────────────────
+sel() { "$BIN" --no-color --no-lu --no-paging --import-subscribers a.bin --subscriber "$1" --show-subscribers | grep "IMSI:"; }
+check "--subscriber IMSI"   'sel 250990000004321 | grep -q 250990000004321'
+check "--subscriber MSISDN" 'sel 79000000042 | grep -q 250990000000042'
+check "--subscriber метка"  'sel UE-777 | grep -q 250990000000777'
+
+# ── 4. --each-subscriber ──────────────────────────────────────────────────
+"$BIN" --no-color --import-subscribers a.bin --send-map-sai --each-subscriber --count 3 \
+       --output=jsonl --output-file o.jsonl > out 2>&1
+check "--each-subscriber: 3 итерации" 'grep -q "итераций 3" out'
+check "--each-subscriber: IMSI по порядку" \
+      '[ "$(grep -o "\"imsi\":\"[0-9]*\"" o.jsonl | tr -d "\"a-z:" | tr "\n" " ")" = "250990000000001 250990000000002 250990000000003 " ]'
+# MSISDN (TBCD 97 00 00 00 00 Fx) и TMSI (MI 05 F4 …) абонента — из записи, а не из --msisdn/--tmsi
+"$BIN" --no-color --import-subscribers a.bin --send-map-isd --send-dtap-tmsi-realloc-cmd --each-subscriber \
+       --count 2 --output=jsonl --output-file m.jsonl > out 2>&1
+check "--each-subscriber: MSISDN из записи" 'grep -qi "9700000000f1" m.jsonl && grep -qi "9700000000f2" m.jsonl'
+check "--each-subscriber: TMSI из записи"   'grep -qi "05f400000001" m.jsonl && grep -qi "05f400000002" m.jsonl'
+"$BIN" --no-color --import-subscribers a.bin --send-map-sai --each-subscriber --send-udp --quiet > out 2>&1
+check "--each-subscriber: проход по всем" 'grep -q "итераций 5000" out'
+# --threads: первая итерация в основном потоке, доли потоков — с индекса 1
+"$BIN" --no-color --import-subscribers a.bin --send-map-sai --each-subscriber --threads 3 \
+       --output=jsonl --output-file t.jsonl > out 2>&1
+grep -o '"imsi":"[0-9]*"' t.jsonl | sort > t.imsi
+check "--threads 3: каждый IMSI ровно один раз" \
+      '[ "$(wc -l < t.imsi)" = 5000 ] && [ "$(uniq < t.imsi | wc -l)" = 5000 ]'
+
+echo "subscriber_import: $PASS passed, $FAIL failed"
+[ "$FAIL" = 0 ]
@@ -0,0 +1,80 @@
+#!/bin/bash
+# Восстановление VLR после сбоя: снимок vmsc_vlr.bin + журнал vmsc_vlr.journal.
+#   1. сеанс --script с частыми компактациями — все записи на месте;
+#   2. kill -9 посреди сеанса — восстановлен префикс регистраций без пропусков;
+#   3. оборванная последняя запись журнала — отброшена, дозапись продолжается;
+#   4. испорченный снимок (CRC) — пропущен, таблица из INI;
+#   5. --vlr-import-ini, когда снимок не записать (.old не разобран), — в журнал.
+# Запуск: tests/vlr_crash_recovery.sh /abs/path/to/vmsc   (ctest: vlr_crash_recovery)
+
+BIN=$(realpath "${1:-./build/vmsc}")
+SRC=$(cd "$(dirname "$0")/.." && pwd)
+DIR=$(mktemp -d)
+PID=
+trap '[ -n "$PID" ] && kill -9 $PID 2>/dev/null; rm -rf "$DIR"' EXIT
+cp "$SRC/vmsc.conf" "$DIR/"
+cd "$DIR" || exit 1
+
+PASS=0
+FAIL=0
+check() {
+    if eval "$2"; then echo "✓ $1"; PASS=$((PASS + 1)); else echo "✗ $1"; FAIL=$((FAIL + 1)); fi
+}
+# IMSI 25099 + 10 цифр номера регистрации
+lines() { for i in $(seq "$1" "$2"); do printf -- '--imsi 25099%010d --vlr-register\n' "$i"; done; }
+vlr()   { "$BIN" --no-color --show-vlr 2>vlr.err | grep -o '^  25099[0-9]\{10\} ' | sed 's/^  25099//; s/ $//; s/^0*//' | sort -n; }
+
+# ── 1. Сеанс с компактациями ──────────────────────────────────────────────
+lines 1 3000 > s1
+"$BIN" --no-color --vlr-compact-kb 16 --script s1 > /dev/null
+vlr > ids
+check "сеанс: 3000 записей" '[ "$(wc -l < ids)" = 3000 ]'
+check "сеанс: нет .old и .tmp" '[ ! -e vmsc_vlr.journal.old ] && [ ! -e vmsc_vlr.bin.tmp ]'
+"$BIN" --no-color --vlr-export-ini out.ini > /dev/null
+check "сеанс: --vlr-export-ini — 3000 записей" '[ "$(grep -c "^imsi *= *25099" out.ini)" = 3000 ]'
+
+# ── 2. kill -9 посреди сеанса ─────────────────────────────────────────────
+lines 3001 400000 > s2
+"$BIN" --no-color --vlr-compact-kb 64 --vlr-sync-ms 2 --script s2 > /dev/null 2>&1 &
+PID=$!
+sleep 1.5
+check "сбой: сеанс ещё шёл" 'kill -0 $PID 2>/dev/null'
+kill -9 $PID
+wait $PID 2>/dev/null
+PID=
+vlr > ids
+N=$(wc -l < ids)
+check "сбой: восстановлено больше 3000 записей ($N)" '[ "$N" -gt 3000 ]'
+check "сбой: записи 1…$N без пропусков" '[ "$(head -1 ids)" = 1 ] && [ "$(tail -1 ids)" = "$N" ]'
+check "сбой: .old после загрузки убран" '[ ! -e vmsc_vlr.journal.old ]'
+
+# ── 3. Оборванная запись в конце журнала ──────────────────────────────────
+"$BIN" --no-color --imsi 250998888888801 --vlr-register > /dev/null
+"$BIN" --no-color --imsi 250998888888802 --vlr-register > /dev/null
+truncate -s -5 vmsc_vlr.journal
+vlr > ids
+check "хвост: последняя запись отброшена" '! grep -q 8888888802 ids && grep -q 8888888801 ids'
+check "хвост: предупреждение" 'grep -q "оборванный хвост" vlr.err'
+"$BIN" --no-color --imsi 250998888888801 --vlr-deregister > /dev/null
+check "хвост: дозапись после обрезки" '"$BIN" --no-color --show-vlr | grep "250998888888801" | grep -q DEREG'
+check "хвост: без повторного предупреждения" '! "$BIN" --no-color --show-vlr 2>&1 >/dev/null | grep -q "оборванный"'
+
+# ── 4. Испорченный снимок ─────────────────────────────────────────────────
+rm -f vmsc_vlr.journal*
+cp out.ini vmsc_vlr.conf
+"$BIN" --no-color --vlr-import-ini > /dev/null
+printf '\x7f' | dd of=vmsc_vlr.bin bs=1 seek=4100 conv=notrunc status=none
+vlr > ids
+check "снимок: порча замечена" 'grep -q "снимок VLR испорчен" vlr.err'
+check "снимок: 3000 записей из INI" '[ "$(wc -l < ids)" = 3000 ]'
+
+# ── 5. --vlr-import-ini без снимка ────────────────────────────────────────
+printf '[entry]\nimsi=250997777777701\nlac=1\n[entry]\nimsi=250997777777702\nlac=1\n' > two.ini
+echo "не журнал" > vmsc_vlr.journal.old
+"$BIN" --no-color --vlr-import-ini two.ini > out 2>&1
+check "импорт: сохранён в журнал" 'grep -q "2 записей из two.ini → .*vmsc_vlr.journal" out'
+vlr > ids
+check "импорт: после перезапуска 2 записи" '[ "$(wc -l < ids)" = 2 ] && grep -q 7777777702 ids'
+
+echo "vlr_crash_recovery: $PASS passed, $FAIL failed"
+[ "$FAIL" = 0 ]